@@ -5,7 +5,13 @@
 #include <Arduino.h>
 #include <PID_v1.h>
 #include <SPI.h>
+#include <driver/gpio.h>
+#include <esp_pm.h>
+#include <esp_sleep.h>
+#include <freertos/event_groups.h>
+#include <freertos/queue.h>
 #include <max6675.h>
+#include <splash.h>
 
 using namespace ace_button;
 
@@ -14,14 +20,15 @@ using namespace ace_button;
 #define PWM_CHANNEL 0
 #define PWM_FREQ 2 // PWM Frequency in Hz
 #define PWM_RES 8  // PWM Resolution in bit
+#define PWM_MAX ((1 << PWM_RES) - 1)
 
-double Setpoint;
-double Input;
-double Output;
-double Kp = 2;
-double Ki = 5;
-double Kd = 1;
-PID THERMO_CONTROL(&Input, &Output, &Setpoint, Kp, Ki, Kd, DIRECT);
+#define CONTROL_PERIOD 1000     // ms between PID updates of one channel
+#define BURST_PERIOD 1000       // ms time base of burst fire outputs, 50 mains cycles at 50 Hz
+#define HEATER_POWER_LIMIT 1000 // W, total average heater power allowed on the mains circuit
+
+constexpr double Kp = 2;
+constexpr double Ki = 5;
+constexpr double Kd = 1;
 /* PID and SSR Definitions end */
 
 /* TFT and Touch Definitions start */
@@ -36,28 +43,419 @@ PID THERMO_CONTROL(&Input, &Output, &Setpoint, Kp, Ki, Kd, DIRECT);
 #define TOUCH_CS 17
 #define TOUCH_CLK 18
 
-Adafruit_ST7789 tft = Adafruit_ST7789(TFT_CS, TFT_DC, TFT_MOSI, TFT_SCLK, TFT_RST);
+#define TFT_SPI_FREQ 40000000 // TFT_MOSI & TFT_SCLK are the VSPI default pins, so use the hardware SPI peripheral
+
+Adafruit_ST7789 tft = Adafruit_ST7789(TFT_CS, TFT_DC, TFT_RST);
 
 #define BACKGROUND_COLOR 0x0820 // blueish black
 #define TEXT_COLOR 0xFFFF       // white
 #define GRAPH_COLOR 0xF800      // red
+#define SETPOINT_COLOR 0x7BEF   // gray
+#define OUTPUT_COLOR 0xFD20     // orange
 
 #define TFT_DELAY 100
 unsigned long lastTFTwrite;
 /* TFT and Touch Definitions end */
 
+/* Graph Definitions start */
+#define GRAPH_LEFT 28        // x of time 0, y axis and its labels sit left of it
+#define GRAPH_RIGHT 312      // x of the end of the time axis
+#define GRAPH_TOP 10         // y of the top of the temperature axis
+#define GRAPH_BOTTOM 126     // y of the bottom of the temperature axis, time labels sit below it
+#define GRAPH_AREA_HEIGHT 141 // rows cleared on repaint, status and temperature charts start below
+#define GRAPH_TEMP_STEP 50   // °C between temperature ticks, axis limits are multiples of it
+#define GRAPH_TEMP_HEADROOM 10 // °C kept free above the hottest value
+#define GRAPH_SAMPLE_PERIOD 250 // ms between samples at the start of a reflow
+#define GRAPH_MAX_SAMPLES 2000  // samples kept, halved to every second sample once full
+#define GRAPH_GAP INT16_MIN     // sample temp of an invalid reading, the temperature trace is interrupted there
+
+// one recorded point of the reflow, time is implied by its index
+struct GraphSample
+{
+  int16_t temp;  // plate temperature in 0.1 °C
+  uint8_t output; // heater duty of channel 0, 0..255
+};
+
+GraphSample graphSamples[GRAPH_MAX_SAMPLES];
+int graphSampleCount = 0;
+int graphDrawnCount = 0; // samples already on screen
+unsigned long graphSamplePeriod = GRAPH_SAMPLE_PERIOD;
+int graphMinTemp;  // °C at GRAPH_BOTTOM
+int graphMaxTemp;  // °C at GRAPH_TOP
+int graphMaxTime;  // s at GRAPH_RIGHT
+bool graphRescaled = false; // axes changed, whole graph has to be repainted
+#define GRAPH_SEGMENT_CHUNK 100 // trace segments drawn between frame budget checks while repainting
+
+// parts of a full graph repaint, spread over several frames while a reflow is running
+enum GraphRepaintStep
+{
+  GRAPH_REPAINT_IDLE,
+  GRAPH_REPAINT_AXES,
+  GRAPH_REPAINT_TEMP_LABELS,
+  GRAPH_REPAINT_TIME_LABELS,
+  GRAPH_REPAINT_SETPOINT,
+  GRAPH_REPAINT_TRACE,
+} graphRepaintStep = GRAPH_REPAINT_IDLE;
+/* Graph Definitions end */
+
+/* Refresh Governor Definitions start */
+#define REFRESH_PERIOD_FAST 250    // ms between screen updates while ramping or near peak
+#define REFRESH_PERIOD_NORMAL 1000 // ms between screen updates while holding temperature
+#define REFRESH_PERIOD_IDLE 2000   // ms between screen updates while no reflow is running and values are stable
+#define REFRESH_RAMP_RATE 0.5      // °C/s of plate temperature change considered a ramp
+#define REFRESH_PEAK_BAND 15       // °C below profile peak considered near peak
+#define FRAME_BUDGET 40            // ms a single screen update may spend before deferring remaining cells
+
+unsigned long refreshPeriod = REFRESH_PERIOD_NORMAL;
+int nextStatusRow = 0; // status cell to continue with if the previous frame ran out of budget
+/* Refresh Governor Definitions end */
+
+/* Glyph Cache Definitions start */
+#define GLYPH_WIDTH 6  // default GFX font at text size 1, including spacing column
+#define GLYPH_HEIGHT 8 // default GFX font at text size 1, including spacing row
+
+// characters used by live values, pre-rendered once at boot
+const char GLYPH_CHARS[] = "0123456789 -CsWARN!";
+#define GLYPH_COUNT (sizeof(GLYPH_CHARS) - 1)
+
+// foreground colors the atlas is rendered in, background is always BACKGROUND_COLOR
+enum GlyphColor
+{
+  GLYPH_TEXT,
+  GLYPH_WARN,
+  GLYPH_COLORS,
+};
+const uint16_t GLYPH_FOREGROUND[GLYPH_COLORS] = {TEXT_COLOR, GRAPH_COLOR};
+
+uint16_t glyphAtlas[GLYPH_COLORS][GLYPH_COUNT][GLYPH_WIDTH * GLYPH_HEIGHT];
+
+// status value cells are composed here and sent in one burst
+#define VALUE_CELL_WIDTH 44
+#define VALUE_CELL_HEIGHT 15
+#define VALUE_CELL_PADDING_X 3
+#define VALUE_CELL_PADDING_Y 4
+uint16_t valueCellBuffer[VALUE_CELL_WIDTH * VALUE_CELL_HEIGHT];
+
+#define VALUE_TEXT_SIZE 16 // fits formatValue() worst case: sign, 10 digits, 2 char unit and terminator
+/* Glyph Cache Definitions end */
+
 /* Temp Sensor Definitions start */
 #define TEMP_SO 26
 #define TEMP_CS1 33 // Plate Sensor 1
 #define TEMP_CS2 14 // Plate Sensor 2
 #define TEMP_CS3 27 // Housing Sensor
 #define TEMP_SCK 12
+#define TEMP_CONVERSION_TIME 250 // MAX6675 needs up to 220 ms after power up for its first conversion
+#define TEMP_SAMPLE_PERIOD 250   // ms between reads, reading faster aborts the running conversion
 
 MAX6675 TEMP1(TEMP_SCK, TEMP_CS1, TEMP_SO); // Plate Sensor 1
 MAX6675 TEMP2(TEMP_SCK, TEMP_CS2, TEMP_SO); // Plate Sensor 2
 MAX6675 TEMP3(TEMP_SCK, TEMP_CS3, TEMP_SO); // Housing Sensor
+
+// cached readings, updated in the sensor slot of loop()
+float plateTemp;
+float plateTempRate; // °C/s, smoothed
+float housingTemp;
+unsigned long lastSensorRead;
 /* Temp Sensor Definitions end */
 
+/* Heater Channel Definitions start */
+#define MAX_ZONE_SENSORS 2
+
+// how a channel switches its SSR
+enum HeaterOutput
+{
+  HEATER_OUTPUT_LEDC,  // hardware PWM at PWM_FREQ, only for a single zone
+  HEATER_OUTPUT_BURST, // software time proportioning over BURST_PERIOD, for zero cross SSRs
+};
+
+// one heater zone: its output, the sensors averaged as its input and its PID tuning
+struct HeaterChannelConfig
+{
+  const char *name;
+  HeaterOutput output;
+  int pin;
+  int ledcChannel; // unused for HEATER_OUTPUT_BURST
+  MAX6675 *sensors[MAX_ZONE_SENSORS];
+  int sensorCount;
+  double kp;
+  double ki;
+  double kd;
+  int ratedPower; // W, used by the power limiter
+};
+
+// add a line per heater zone, channel 0 is the plate shown on screen
+constexpr HeaterChannelConfig HEATER_CHANNELS[] = {
+    {"Plate", HEATER_OUTPUT_LEDC, PWM_PIN, PWM_CHANNEL, {&TEMP1, &TEMP2}, 2, Kp, Ki, Kd, 1000},
+};
+#define HEATER_CHANNEL_COUNT (sizeof(HEATER_CHANNELS) / sizeof(HEATER_CHANNELS[0]))
+
+constexpr bool allBurstOutputs(const HeaterChannelConfig *configs, const size_t count)
+{
+  return count == 0 || (configs[0].output == HEATER_OUTPUT_BURST && allBurstOutputs(configs + 1, count - 1));
+}
+
+// on-windows are only phased against each other on the BURST_PERIOD time base,
+// LEDC timers run at their own period and are not synchronized between channels
+static_assert(HEATER_CHANNEL_COUNT == 1 || allBurstOutputs(HEATER_CHANNELS, HEATER_CHANNEL_COUNT),
+              "several heater zones must all use HEATER_OUTPUT_BURST");
+
+// runtime state of one heater zone
+class HeaterChannel
+{
+public:
+  HeaterChannel() : pid(&input, &output, &setpoint, 0, 0, 0, DIRECT) {}
+
+  double input = 0;
+  double output = 0;
+  double setpoint = 0;
+  PID pid;
+
+  float duty = 0;  // granted share of the output period after power limiting, 0..1
+  float phase = 0; // start of the on-window within the output period, 0..1
+  bool faulted = false; // a sensor of the group reads NAN, output is held off
+
+
+  unsigned long nextSample = 0;
+  unsigned long nextControl = 0;
+};
+
+// drives N heater zones from the HEATER_CHANNELS table
+// sensor reads and PID updates of the channels are staggered across their periods,
+// outputs are scaled to HEATER_POWER_LIMIT and their on-windows placed back to back within BURST_PERIOD
+// to cap peak current, a single zone may use LEDC instead since there is nothing to phase it against
+template <size_t N> class HeaterEngine
+{
+public:
+  explicit HeaterEngine(const HeaterChannelConfig (&configs)[N]) : configs(configs) {}
+
+  // drive every output safe-off and set up the PID loops, call first thing at boot
+  void begin()
+  {
+    const unsigned long now = millis();
+
+    for (size_t i = 0; i < N; i++)
+    {
+      const HeaterChannelConfig &config = configs[i];
+
+      pinMode(config.pin, OUTPUT);
+      digitalWrite(config.pin, LOW);
+      if (config.output == HEATER_OUTPUT_LEDC)
+      {
+        ledcSetup(config.ledcChannel, PWM_FREQ, PWM_RES);
+        ledcAttachPin(config.pin, config.ledcChannel);
+        ledcWrite(config.ledcChannel, 0);
+      }
+
+      channels[i].pid.SetTunings(config.kp, config.ki, config.kd);
+      channels[i].pid.SetOutputLimits(0, PWM_MAX);
+      channels[i].pid.SetMode(AUTOMATIC);
+
+      channels[i].nextSample = now + i * TEMP_SAMPLE_PERIOD / N;
+      channels[i].nextControl = now + i * CONTROL_PERIOD / N;
+    }
+  }
+
+  // sensor slot: read the sensor group of every channel that is due
+  // a NAN reading (open thermocouple) faults the zone: its output goes off at once and it leaves the power limiter,
+  // once all its sensors read again the PID restarts from the current input
+  void sample(const unsigned long now)
+  {
+    bool newFault = false;
+
+    for (size_t i = 0; i < N; i++)
+    {
+      HeaterChannel &channel = channels[i];
+      if (!isDue(now, channel.nextSample, TEMP_SAMPLE_PERIOD))
+      {
+        continue;
+      }
+
+      float sum = 0;
+      for (int sensor = 0; sensor < configs[i].sensorCount; sensor++)
+      {
+        sum += configs[i].sensors[sensor]->readCelsius();
+      }
+      channel.input = sum / configs[i].sensorCount;
+
+      if (isnan(channel.input) && !channel.faulted)
+      {
+        Serial.printf("WARN > HeaterEngine::sample(): %s sensor fault, output off\n", configs[i].name);
+        channel.faulted = true;
+        channel.output = 0;
+        newFault = true;
+      }
+      else if (!isnan(channel.input) && channel.faulted)
+      {
+        Serial.printf("INFO > HeaterEngine::sample(): %s sensors recovered\n", configs[i].name);
+        channel.faulted = false;
+        channel.pid.SetMode(MANUAL);
+        channel.pid.SetMode(AUTOMATIC);
+      }
+    }
+
+    if (newFault)
+    {
+      limitPower();
+      writeOutputs();
+      drive(now);
+    }
+  }
+
+  // control slot: update the PID of every channel that is due
+  // disabling switches every output off at once, enabling restarts the PIDs without the previous integral term
+  void control(const unsigned long now, const bool enabled)
+  {
+    const bool switched = enabled != wasEnabled;
+    wasEnabled = enabled;
+
+    if (!enabled)
+    {
+      if (switched)
+      {
+        for (size_t i = 0; i < N; i++)
+        {
+          channels[i].output = 0;
+          channels[i].duty = 0;
+        }
+        writeOutputs();
+        drive(now);
+        Serial.println("INFO > HeaterEngine::control(): PWM off");
+      }
+      return;
+    }
+
+    if (switched)
+    {
+      for (size_t i = 0; i < N; i++)
+      {
+        channels[i].pid.SetMode(MANUAL);
+        channels[i].pid.SetMode(AUTOMATIC);
+      }
+    }
+
+    bool changed = false;
+    for (size_t i = 0; i < N; i++)
+    {
+      HeaterChannel &channel = channels[i];
+      if (!isDue(now, channel.nextControl, CONTROL_PERIOD))
+      {
+        continue;
+      }
+
+      if (channel.faulted)
+      {
+        continue;
+      }
+
+      channel.pid.Compute();
+      Serial.printf("TRACE > HeaterEngine::control(): %s\tInput: %f\tSetpoint: %f\tOutput: %f\n", configs[i].name,
+                    channel.input, channel.setpoint, channel.output);
+      changed = true;
+    }
+
+    if (changed)
+    {
+      limitPower();
+      writeOutputs();
+    }
+  }
+
+  // burst fire outputs are switched in software and need a call every loop() pass
+  void drive(const unsigned long now)
+  {
+    const float position = (now % BURST_PERIOD) / (float)BURST_PERIOD;
+
+    for (size_t i = 0; i < N; i++)
+    {
+      if (configs[i].output != HEATER_OUTPUT_BURST)
+      {
+        continue;
+      }
+
+      const HeaterChannel &channel = channels[i];
+      const bool on = position >= channel.phase && position < channel.phase + channel.duty;
+      digitalWrite(configs[i].pin, on ? HIGH : LOW);
+    }
+  }
+
+  void setSetpoint(const double setpoint)
+  {
+    for (size_t i = 0; i < N; i++)
+    {
+      channels[i].setpoint = setpoint;
+    }
+  }
+
+  float temperature(const size_t channel) const { return channels[channel].input; }
+  float duty(const size_t channel) const { return channels[channel].duty; }
+
+private:
+  // advance a slot deadline, a slot that fell more than a period behind is rescheduled from now
+  static bool isDue(const unsigned long now, unsigned long &deadline, const unsigned long period)
+  {
+    if ((long)(now - deadline) < 0)
+    {
+      return false;
+    }
+
+    deadline += period;
+    if ((long)(now - deadline) >= 0)
+    {
+      deadline = now + period;
+    }
+    return true;
+  }
+
+  // scale all requested duties down if their average power exceeds HEATER_POWER_LIMIT,
+  // then place the on-windows back to back so they only overlap once the limit allows it
+  void limitPower()
+  {
+    float requested = 0;
+    for (size_t i = 0; i < N; i++)
+    {
+      if (!channels[i].faulted)
+      {
+        requested += channels[i].output / PWM_MAX * configs[i].ratedPower;
+      }
+    }
+    const float scale = requested > HEATER_POWER_LIMIT ? HEATER_POWER_LIMIT / requested : 1;
+
+    float phase = 0;
+    for (size_t i = 0; i < N; i++)
+    {
+      HeaterChannel &channel = channels[i];
+      channel.duty = channel.faulted ? 0 : channel.output / PWM_MAX * scale;
+
+      // a window must not wrap around the period end, pull it back instead
+      channel.phase = phase + channel.duty > 1 ? 1 - channel.duty : phase;
+      phase = fmod(channel.phase + channel.duty, 1);
+    }
+  }
+
+  void writeOutputs()
+  {
+    for (size_t i = 0; i < N; i++)
+    {
+      const HeaterChannelConfig &config = configs[i];
+      if (config.output != HEATER_OUTPUT_LEDC)
+      {
+        continue;
+      }
+
+      // only ever the single zone, so its window starts at phase 0
+      ledcWrite(config.ledcChannel, channels[i].duty * PWM_MAX);
+    }
+  }
+
+  const HeaterChannelConfig (&configs)[N];
+  HeaterChannel channels[N];
+  bool wasEnabled = false;
+};
+
+HeaterEngine<HEATER_CHANNEL_COUNT> HEATERS(HEATER_CHANNELS);
+/* Heater Channel Definitions end */
+
 /* Button definitions start */
 #define BUTTON_PIN1 32
 #define BUTTON_PIN2 35
@@ -66,10 +464,11 @@ MAX6675 TEMP3(TEMP_SCK, TEMP_CS3, TEMP_SO); // Housing Sensor
 #define DEBOUNCE_DELAY 50
 const int BUTTON_PINS[4] = {BUTTON_PIN1, BUTTON_PIN2, BUTTON_PIN3, BUTTON_PIN4};
 
-AceButton button1(BUTTON_PIN1);
-AceButton button2(BUTTON_PIN2);
-AceButton button3(BUTTON_PIN3);
-AceButton button4(BUTTON_PIN4);
+// button id is the index into the transitions of the state table
+AceButton button1(BUTTON_PIN1, HIGH, 0);
+AceButton button2(BUTTON_PIN2, HIGH, 1);
+AceButton button3(BUTTON_PIN3, HIGH, 2);
+AceButton button4(BUTTON_PIN4, HIGH, 3);
 /* Button definitions end */
 
 #define MS_TO_S 1000    // ms in s conversion factor
@@ -84,6 +483,7 @@ enum State
   STATE_REFLOW_LANDING,
   STATE_REFLOW_STARTED,
   STATE_REFLOW_FINISHED,
+  STATE_MAX,
 } currentState;
 
 // currently set reflow profile
@@ -112,23 +512,74 @@ const int SOLDER_PROFILES[Profile::MAX][5][2]{
 };
 
 int reflowRuntime = 0;
+unsigned long reflowStartTime; // millis() at transition to STATE_REFLOW_STARTED
 /* Menu definitions end */
 
 /* Multi Core Setup start */
 TaskHandle_t BUTTON_HANDLER;
 TaskHandle_t PWM_OUTPUT;
+TaskHandle_t DISPLAY_INIT;
+TaskHandle_t SENSOR_INIT;
+
+// ids of pressed buttons, posted by handleEvent() on core 0 and applied by loop() on core 1,
+// so the state machine is only ever changed from one core
+#define BUTTON_QUEUE_LENGTH 8
+QueueHandle_t BUTTON_QUEUE;
 /* Multi Core Setup end */
 
+/* Power Management Definitions start */
+#define CPU_FREQ_MAX 240          // MHz while a reflow is running
+#define CPU_FREQ_IDLE 80          // MHz otherwise, lowest frequency that keeps APB at 80 MHz for LEDC and SPI
+#define BUTTON_POLL_ACTIVE 10     // ms between button polls while a reflow is running
+#define BUTTON_POLL_IDLE 25       // ms between button polls while idle, leaves room for light sleep
+#define LOOP_IDLE_DELAY 25        // ms loop() yields per pass while idle
+#define POWER_REPORT_PERIOD 60000 // ms between idle power reports
+
+// assumed MCU currents taken from the ESP32 datasheet, not measured on this board (it has no current sense)
+// they only weight the measured busy share into a rough idle current estimate
+#define CURRENT_ACTIVE_ESTIMATE 31.0     // mA, CPU running at CPU_FREQ_IDLE
+#define CURRENT_NO_SLEEP_ESTIMATE 20.0   // mA, CPU waiting at CPU_FREQ_IDLE without light sleep
+#define CURRENT_LIGHT_SLEEP_ESTIMATE 0.8 // mA, automatic light sleep
+
+#if CONFIG_PM_ENABLE
+esp_pm_lock_handle_t REFLOW_FREQ_LOCK;
+esp_pm_lock_handle_t REFLOW_SLEEP_LOCK;
+bool pmLocksHeld = false;
+#endif
+bool pmEnabled = false;          // esp_pm handles frequency scaling, otherwise setCpuFrequencyMhz() is used
+bool lightSleepEnabled = false;  // tickless idle with automatic light sleep is active
+bool performanceMode = true;     // CPU held at CPU_FREQ_MAX, cleared by powerInit()
+unsigned long loopActiveTime;    // us spent working in loop() since last power report
+unsigned long buttonActiveTime;  // us spent working in BUTTON_HANDLER_CODE since last power report
+unsigned long lastPowerReport;
+/* Power Management Definitions end */
+
+/* Boot Definitions start */
+#define BOOT_DISPLAY_READY BIT0
+#define BOOT_SENSORS_READY BIT1
+#define BOOT_INPUT_READY BIT2
+#define BOOT_ALL_READY (BOOT_DISPLAY_READY | BOOT_SENSORS_READY | BOOT_INPUT_READY)
+#define BOOT_TIMEOUT 2000 // ms to wait for sensors and buttons before continuing anyway, the display is always awaited
+
+EventGroupHandle_t BOOT_EVENTS;
+bool bootTimeLogged = false;
+/* Boot Definitions end */
+
 /* Prototypes start */
 void reflowLandingScreen(const int profileId);
 void reflowStartedScreen(const int profileId);
+void printReflowStartedHint();
 void handleEvent(AceButton *, uint8_t, uint8_t);
 void BUTTON_HANDLER_CODE(void *pvParameters);
+void DISPLAY_INIT_CODE(void *pvParameters);
+void SENSOR_INIT_CODE(void *pvParameters);
+void powerInit();
+void setPowerMode(const bool reflowRunning);
 int getSetPoint(const int profileId, const int runtime);
+void requestState(const State next);
 /* Prototypes end */
 
 unsigned long lastSerialPrint0 = millis();
-unsigned long lastSerialPrint1 = millis();
 
 // calculate total time of selected solder profile
 inline int getTotalTime(const int profileId)
@@ -221,136 +672,374 @@ inline void printStatusChart()
   }
 }
 
-// fill/update status chart with values in reflow screen
-inline void printStatusChartValues(const int profileId, const int currentTime)
+// render every glyph of GLYPH_CHARS in every GlyphColor as an opaque RGB565 block
+void buildGlyphAtlas()
 {
-  Serial.println("TRACE > printStatusChartValues()");
+  GFXcanvas16 canvas(GLYPH_WIDTH, GLYPH_HEIGHT);
 
-  tft.setTextSize(1);
+  for (int color = 0; color < GLYPH_COLORS; color++)
+  {
+    for (size_t glyph = 0; glyph < GLYPH_COUNT; glyph++)
+    {
+      canvas.fillScreen(BACKGROUND_COLOR);
+      canvas.drawChar(0, 0, GLYPH_CHARS[glyph], GLYPH_FOREGROUND[color], BACKGROUND_COLOR, 1);
+      memcpy(glyphAtlas[color][glyph], canvas.getBuffer(), sizeof(glyphAtlas[color][glyph]));
+    }
+  }
+}
 
-  const int COLUMNS = 5;
-  const int Y_VALUES[COLUMNS] = {150, 167, 184, 201, 218};
-  float temp = (TEMP1.readCelsius() + TEMP2.readCelsius()) / 2;
+// write integer followed by unit into buf without going through printf, buf needs VALUE_TEXT_SIZE bytes
+inline void formatValue(char *buf, int value, const char *unit)
+{
+  char digits[10];
+  int len = 0;
+  unsigned int magnitude = value < 0 ? -(unsigned int)value : value;
 
-  Serial.println("TRACE > printStatusChartValues(): Temperature Readings:");
-  Serial.printf("\tSensor 1: %f °C", TEMP1.readCelsius());
-  Serial.printf("\tSensor 2: %f °C", TEMP2.readCelsius());
-  Serial.printf("\tSensor 3: %f °C\n", TEMP3.readCelsius());
+  do
+  {
+    digits[len++] = '0' + magnitude % 10;
+    magnitude /= 10;
+  } while (magnitude > 0);
 
-  for (int row = 0; row < COLUMNS; row++)
+  if (value < 0)
   {
-    tft.fillRect(109, 150 + ((15 + 2) * row), 44, 15, BACKGROUND_COLOR);
-    tft.setCursor(109 + 3, 150 + ((15 + 2) * row) + 4);
+    *buf++ = '-';
+  }
+  while (len > 0)
+  {
+    *buf++ = digits[--len];
+  }
+  while (*unit)
+  {
+    *buf++ = *unit++;
+  }
+  *buf = '\0';
+}
 
-    switch (row)
+// draw text into an opaque value cell from the glyph atlas
+// the cell background is part of the burst, so no fillRect is needed beforehand
+void drawValueCell(const int x, const int y, const char *text, const GlyphColor color)
+{
+  for (int i = 0; i < VALUE_CELL_WIDTH * VALUE_CELL_HEIGHT; i++)
+  {
+    valueCellBuffer[i] = BACKGROUND_COLOR;
+  }
+
+  int glyphX = VALUE_CELL_PADDING_X;
+  for (; *text && glyphX + GLYPH_WIDTH <= VALUE_CELL_WIDTH; text++, glyphX += GLYPH_WIDTH)
+  {
+    const char *glyph = strchr(GLYPH_CHARS, *text);
+    if (glyph == NULL)
     {
-    // Temp MCU
-    case 0:
-      if (true)
-      {
-        tft.setTextColor(GRAPH_COLOR);
-        tft.printf("WARN!");
-        tft.setTextColor(TEXT_COLOR);
-      }
-      else
-      {
-        tft.printf("%d C", int(TEMP1.readCelsius()));
-      }
-      break;
-    // Temp Housing
-    case 1:
-      if (int(TEMP3.readCelsius()) > 50)
-      {
-        tft.setTextColor(GRAPH_COLOR);
-        tft.printf("%d C", int(TEMP3.readCelsius()));
-        tft.setTextColor(TEXT_COLOR);
-      }
-      else
-      {
-        tft.printf("%d C", int(TEMP3.readCelsius()));
-      }
-      break;
-    // Temp Setpoint
-    case 2:
-      tft.printf("%d C", getSetPoint(currentProfile, currentTime));
-      break;
-    // Temp Plate
-    case 3:
-      if (temp > 280 || temp < 0)
-      {
-        tft.setTextColor(GRAPH_COLOR);
-        tft.printf("WARN!");
-        tft.setTextColor(TEXT_COLOR);
-      }
-      else
+      continue;
+    }
+
+    const uint16_t *src = glyphAtlas[color][glyph - GLYPH_CHARS];
+    for (int row = 0; row < GLYPH_HEIGHT; row++)
+    {
+      memcpy(&valueCellBuffer[(VALUE_CELL_PADDING_Y + row) * VALUE_CELL_WIDTH + glyphX], &src[row * GLYPH_WIDTH],
+             GLYPH_WIDTH * sizeof(uint16_t));
+    }
+  }
+
+  tft.startWrite();
+  tft.setAddrWindow(x, y, VALUE_CELL_WIDTH, VALUE_CELL_HEIGHT);
+  tft.writePixels(valueCellBuffer, VALUE_CELL_WIDTH * VALUE_CELL_HEIGHT);
+  tft.endWrite();
+}
+
+// fill/update a single row of the status chart in reflow screen
+inline void printStatusChartValue(const int row, const int profileId, const int currentTime)
+{
+  const int Y_VALUES[5] = {150, 167, 184, 201, 218};
+
+  char text[VALUE_TEXT_SIZE];
+  GlyphColor color = GLYPH_TEXT;
+
+  switch (row)
+  {
+  // Temp MCU, not measured yet
+  case 0:
+    strcpy(text, "WARN!");
+    color = GLYPH_WARN;
+    break;
+  // Temp Housing, NAN for an open thermocouple
+  case 1:
+    if (isnan(housingTemp))
+    {
+      strcpy(text, "WARN!");
+      color = GLYPH_WARN;
+    }
+    else
+    {
+      formatValue(text, int(housingTemp), " C");
+      if (int(housingTemp) > 50)
       {
-        tft.printf("%i C", int(temp));
+        color = GLYPH_WARN;
       }
-      break;
-    // Runtime
-    case 4:
-      tft.print(getTotalTime(profileId) - currentTime);
-      tft.println(" s");
-      break;
     }
+    break;
+  // Temp Setpoint
+  case 2:
+    formatValue(text, getSetPoint(currentProfile, currentTime), " C");
+    break;
+  // Temp Plate
+  case 3:
+    if (isnan(plateTemp) || plateTemp > 280 || plateTemp < 0)
+    {
+      strcpy(text, "WARN!");
+      color = GLYPH_WARN;
+    }
+    else
+    {
+      formatValue(text, int(plateTemp), " C");
+    }
+    break;
+  // Runtime
+  case 4:
+    formatValue(text, getTotalTime(profileId) - currentTime, " s");
+    break;
+  }
+
+  drawValueCell(109, Y_VALUES[row], text, color);
+}
+
+// fill/update status chart with values in reflow screen
+inline void printStatusChartValues(const int profileId, const int currentTime)
+{
+  Serial.println("TRACE > printStatusChartValues()");
+
+  for (int row = 0; row < 5; row++)
+  {
+    printStatusChartValue(row, profileId, currentTime);
+  }
+}
+
+// map a point in time to its x coordinate
+inline int graphX(const unsigned long time)
+{
+  return GRAPH_LEFT + (long long)time * (GRAPH_RIGHT - GRAPH_LEFT) / ((long long)graphMaxTime * MS_TO_S);
+}
+
+// map a temperature to its y coordinate
+inline int graphY(const float temp)
+{
+  return GRAPH_BOTTOM - (temp - graphMinTemp) * (GRAPH_BOTTOM - GRAPH_TOP) / (graphMaxTemp - graphMinTemp);
+}
+
+// map a heater duty to its y coordinate, full duty spans the whole axis
+inline int graphOutputY(const uint8_t output)
+{
+  return GRAPH_BOTTOM - output * (GRAPH_BOTTOM - GRAPH_TOP) / 255;
+}
+
+// fit the axes to the profile and every recorded sample
+void graphScale(const int profileId)
+{
+  float coldest = 0;
+  float hottest = SOLDER_PROFILES[profileId][2][0];
+  for (int i = 0; i < graphSampleCount; i++)
+  {
+    if (graphSamples[i].temp == GRAPH_GAP)
+    {
+      continue;
+    }
+    coldest = min(coldest, graphSamples[i].temp / 10.0f);
+    hottest = max(hottest, graphSamples[i].temp / 10.0f);
   }
+
+  const int elapsed = (graphSampleCount * graphSamplePeriod + MS_TO_S - 1) / MS_TO_S;
+
+  graphMinTemp = floor(coldest / GRAPH_TEMP_STEP) * GRAPH_TEMP_STEP;
+  graphMaxTemp = ceil((hottest + GRAPH_TEMP_HEADROOM) / GRAPH_TEMP_STEP) * GRAPH_TEMP_STEP;
+  // empty custom profiles have no duration, keep graphX() from dividing by zero
+  graphMaxTime = max(max(getTotalTime(profileId), elapsed), 1);
 }
 
-// print ideal temperature graph of selected reflow profile in reflow screen
-inline void printTemperatureGraph(const int profileId)
+// forget the recorded reflow and scale the axes to the profile alone
+void graphReset(const int profileId)
 {
-  Serial.println("TRACE > printTemperatureGraph()");
+  graphSampleCount = 0;
+  graphDrawnCount = 0;
+  graphSamplePeriod = GRAPH_SAMPLE_PERIOD;
+  graphRescaled = false;
+  graphRepaintStep = GRAPH_REPAINT_IDLE;
+  graphScale(profileId);
+}
 
-  const int BOTTOM_LEFT_X = 12;
-  const int BOTTOM_LEFT_Y = 132;
-  const int TOP_RIGHT_X = 310;
-  const int TOP_RIGHT_Y = 10;
-  const int WIDTH = TOP_RIGHT_X - BOTTOM_LEFT_X;
-  const int HEIGHT = BOTTOM_LEFT_Y - TOP_RIGHT_Y;
+// record plate temperature and heater output at the graph sample rate
+// the axes are rescaled as soon as a sample leaves them
+void graphSample(const int profileId, const unsigned long elapsed)
+{
+  if (elapsed < graphSampleCount * graphSamplePeriod)
+  {
+    return;
+  }
+
+  if (graphSampleCount == GRAPH_MAX_SAMPLES)
+  {
+    // keep every second sample, the trace keeps its shape at half the time resolution
+    for (int i = 0; i < GRAPH_MAX_SAMPLES / 2; i++)
+    {
+      graphSamples[i] = graphSamples[2 * i];
+    }
+    graphSampleCount = GRAPH_MAX_SAMPLES / 2;
+    graphSamplePeriod *= 2;
+    graphRescaled = true;
+  }
 
-  // initialize x & y with the bottom left corner of screen
-  int x = BOTTOM_LEFT_X;
-  int y = BOTTOM_LEFT_Y;
+  GraphSample &sample = graphSamples[graphSampleCount++];
+  sample.output = HEATERS.duty(0) * 255;
 
-  // calculate X/Y coordinates of reflow curve in respect to screen space available
-  for (int i = 0; i < 5; i++)
+  // MAX6675 reports NAN for an open thermocouple, leave a gap instead of inventing a value
+  const bool valid = !isnan(plateTemp);
+  sample.temp = valid ? plateTemp * 10 : GRAPH_GAP;
+
+  if ((valid && (plateTemp > graphMaxTemp - GRAPH_TEMP_HEADROOM || plateTemp < graphMinTemp)) ||
+      elapsed > (unsigned long)graphMaxTime * MS_TO_S)
   {
-    // calculate required X delta: (StepTime of profile / TotalTime of profile) * ScreenWidth available
-    int deltaX = (SOLDER_PROFILES[profileId][i][1] / (float)getTotalTime(profileId)) * WIDTH;
-    // calculate required Y delta: (StepTemp of profile / MaxTemp of profile) * ScreenHeight available
-    int deltaY = (SOLDER_PROFILES[profileId][i][0] / (float)SOLDER_PROFILES[profileId][2][0]) * HEIGHT;
+    graphScale(profileId);
+    graphRescaled = true;
+  }
+}
+
+// draw the recorded traces ending at samples first to last - 1, must be called inside startWrite/endWrite
+inline void writeGraphSegments(const int first, const int last)
+{
+  for (int i = max(first, 1); i < last; i++)
+  {
+    const int x0 = graphX((i - 1) * graphSamplePeriod);
+    const int x1 = graphX(i * graphSamplePeriod);
+    tft.writeLine(x0, graphOutputY(graphSamples[i - 1].output), x1, graphOutputY(graphSamples[i].output),
+                  OUTPUT_COLOR);
+    if (graphSamples[i - 1].temp != GRAPH_GAP && graphSamples[i].temp != GRAPH_GAP)
+    {
+      tft.writeLine(x0, graphY(graphSamples[i - 1].temp / 10.0f), x1, graphY(graphSamples[i].temp / 10.0f),
+                    GRAPH_COLOR);
+    }
+  }
+  graphDrawnCount = max(graphDrawnCount, last);
+}
 
-    // draw line from old X & Y to new X & Y
-    tft.drawLine(x, y, x + deltaX, BOTTOM_LEFT_Y - deltaY, TEXT_COLOR);
+// run the current step of a full graph repaint, the trace is drawn GRAPH_SEGMENT_CHUNK segments at a time
+// returns true once axes, tick labels, setpoint and all recorded traces are on screen
+bool printGraphStep(const int profileId)
+{
+  char label[VALUE_TEXT_SIZE];
 
-    // update X & Y with calculated delta to print next line
-    y = BOTTOM_LEFT_Y - deltaY;
-    x += deltaX;
+  switch (graphRepaintStep)
+  {
+  case GRAPH_REPAINT_IDLE:
+    return true;
+  case GRAPH_REPAINT_AXES:
+    tft.fillRect(0, 0, tft.width(), GRAPH_AREA_HEIGHT, BACKGROUND_COLOR);
+    tft.fillRect(GRAPH_LEFT - 3, GRAPH_TOP, 2, GRAPH_BOTTOM - GRAPH_TOP + 3, TEXT_COLOR);        // y-axis
+    tft.fillRect(GRAPH_LEFT - 3, GRAPH_BOTTOM + 1, GRAPH_RIGHT - GRAPH_LEFT + 3, 2, TEXT_COLOR); // x-axis
+    graphDrawnCount = 0;
+    graphRepaintStep = GRAPH_REPAINT_TEMP_LABELS;
+    return false;
+  case GRAPH_REPAINT_TEMP_LABELS:
+    tft.setTextSize(1);
+    tft.setTextColor(TEXT_COLOR);
+    for (int temp = graphMinTemp; temp <= graphMaxTemp; temp += GRAPH_TEMP_STEP)
+    {
+      const int y = graphY(temp);
+      formatValue(label, temp, "");
+      tft.drawFastHLine(GRAPH_LEFT - 6, y, 3, TEXT_COLOR);
+      tft.setCursor(GRAPH_LEFT - 8 - strlen(label) * 6, y - 3);
+      tft.print(label);
+    }
+    graphRepaintStep = GRAPH_REPAINT_TIME_LABELS;
+    return false;
+  case GRAPH_REPAINT_TIME_LABELS:
+  {
+    const int timeStep = graphMaxTime > 240 ? 60 : 30;
+    tft.setTextSize(1);
+    tft.setTextColor(TEXT_COLOR);
+    for (int time = 0; time <= graphMaxTime; time += timeStep)
+    {
+      const int x = graphX((unsigned long)time * MS_TO_S);
+      formatValue(label, time, "");
+      tft.drawFastVLine(x, GRAPH_BOTTOM + 3, 3, TEXT_COLOR);
+      tft.setCursor(x - strlen(label) * 3, GRAPH_BOTTOM + 7);
+      tft.print(label);
+    }
+    graphRepaintStep = GRAPH_REPAINT_SETPOINT;
+    return false;
   }
+  case GRAPH_REPAINT_SETPOINT:
+  {
+    // setpoint of each profile step, cooldown included
+    int time = 0;
+    int lastY = graphY(getSetPoint(profileId, 0));
+    tft.startWrite();
+    for (int i = 0; i < 5; i++)
+    {
+      const int end = time + SOLDER_PROFILES[profileId][i][1];
+      const int y = graphY(getSetPoint(profileId, time));
+      tft.writeLine(graphX(time * MS_TO_S), lastY, graphX(time * MS_TO_S), y, SETPOINT_COLOR);
+      tft.writeLine(graphX(time * MS_TO_S), y, graphX(end * MS_TO_S), y, SETPOINT_COLOR);
+      time = end;
+      lastY = y;
+    }
+    tft.endWrite();
+    graphRepaintStep = GRAPH_REPAINT_TRACE;
+    return false;
+  }
+  case GRAPH_REPAINT_TRACE:
+    tft.startWrite();
+    writeGraphSegments(graphDrawnCount, min(graphDrawnCount + GRAPH_SEGMENT_CHUNK, graphSampleCount));
+    tft.endWrite();
+    if (graphDrawnCount < graphSampleCount)
+    {
+      return false;
+    }
+    graphRepaintStep = GRAPH_REPAINT_IDLE;
+    return true;
+  }
+  return true;
+}
+
+// repaint axes, tick labels, setpoint of the selected profile and all recorded traces in one go
+void printGraph(const int profileId)
+{
+  Serial.println("TRACE > printGraph()");
 
-  tft.fillRect(5, 5, 2, 134, TEXT_COLOR);   // y-axis
-  tft.fillRect(5, 137, 310, 2, TEXT_COLOR); // x-axis
+  graphRescaled = false;
+  graphRepaintStep = GRAPH_REPAINT_AXES;
+  while (!printGraphStep(profileId))
+  {
+  }
 }
 
-// print actual temperature graph while reflow process is running
-inline void printReflowGraph(const int profileId, const int currentTime)
+// append the samples recorded since the last call
+// if the axes changed, the whole graph is repainted step by step within the frame budget instead
+inline void printGraphUpdate(const int profileId, const unsigned long frameStart)
 {
-  Serial.println("TRACE > printReflowGraph()");
+  if (graphRescaled)
+  {
+    // restarts a repaint still in progress, its axes are outdated
+    Serial.println("TRACE > printGraphUpdate(): repaint");
+    graphRescaled = false;
+    graphRepaintStep = GRAPH_REPAINT_AXES;
+  }
 
-  const int BOTTOM_LEFT_X = 12;
-  const int BOTTOM_LEFT_Y = 132;
-  const int TOP_RIGHT_X = 310;
-  const int TOP_RIGHT_Y = 10;
-  const int WIDTH = TOP_RIGHT_X - BOTTOM_LEFT_X;
-  const int HEIGHT = BOTTOM_LEFT_Y - TOP_RIGHT_Y;
-  float temp = (TEMP1.readCelsius() + TEMP2.readCelsius()) / 2;
+  if (graphRepaintStep != GRAPH_REPAINT_IDLE)
+  {
+    do
+    {
+      if (printGraphStep(profileId))
+      {
+        printReflowStartedHint();
+        return;
+      }
+    } while (millis() - frameStart < FRAME_BUDGET);
+    return;
+  }
 
-  // calculate X: (TimeElapsed of process / TotalTime of profile) * ScreenWidth available
-  float x = BOTTOM_LEFT_X + ((currentTime / (float)getTotalTime(profileId)) * WIDTH);
-  // calculate Y: (TempSensor / MaxTemp of profile) * ScreenWidth available
-  float y = BOTTOM_LEFT_Y - (temp / (float)SOLDER_PROFILES[profileId][2][0]) * HEIGHT;
-  // draw pixel in calculated location
-  tft.drawPixel(x, y, GRAPH_COLOR);
+  tft.startWrite();
+  writeGraphSegments(graphDrawnCount, graphSampleCount);
+  tft.endWrite();
 }
 
 // print start screen with selected reflow profile
@@ -377,7 +1066,7 @@ void startScreen(const int profileId)
 }
 
 // print profile select screen to select desired reflow profile
-void profileSelectScreen()
+void profileSelectScreen(const int)
 {
   Serial.println("TRACE > profileSelectScreen()");
 
@@ -414,16 +1103,15 @@ void reflowLandingScreen(const int profileId)
   printStatusChart();
   printStatusChartValues(profileId, 0);
 
-  // this does not need to be done every time.
-  // consider caching the result
-  printTemperatureGraph(profileId);
+  graphReset(profileId);
+  printGraph(profileId);
 
   // textbox for abort and start
-  tft.fillRect(15, 10, 100, 30, TEXT_COLOR);
+  tft.fillRect(40, 10, 100, 30, TEXT_COLOR);
   tft.setTextColor(BACKGROUND_COLOR);
-  tft.setCursor(17, 14);
+  tft.setCursor(42, 14);
   tft.println("Press 1 to abort");
-  tft.setCursor(17, 29);
+  tft.setCursor(42, 29);
   tft.println("Press 2 to start");
   tft.setTextColor(TEXT_COLOR);
 
@@ -439,24 +1127,32 @@ void reflowLandingScreen(const int profileId)
 }
 
 // keep screen updated after reflow process started
-void reflowStartedScreen(const int profileId)
+// textbox for abort while reflow process is running
+void printReflowStartedHint()
 {
-  Serial.println("TRACE > reflowStartedScreen()");
-
-  // textbox for abort
-  tft.fillRect(15, 25, 100, 15, BACKGROUND_COLOR);
-  tft.fillRect(15, 10, 137, 15, TEXT_COLOR);
+  tft.fillRect(40, 10, 137, 15, TEXT_COLOR);
   tft.setTextColor(BACKGROUND_COLOR);
-  tft.setCursor(17, 14);
+  tft.setCursor(42, 14);
   tft.println("Press any key to abort");
   tft.setTextColor(TEXT_COLOR);
+}
+
+void reflowStartedScreen(const int profileId)
+{
+  Serial.println("TRACE > reflowStartedScreen()");
+
+  graphReset(profileId);
+  printGraph(profileId);
+  printReflowStartedHint();
 
   lastTFTwrite = millis();
 }
 
-void reflowFinishedScreen()
+void reflowFinishedScreen(const int profileId)
 {
-  tft.fillRect(15, 10, 140, 30, BACKGROUND_COLOR);
+  // repaint the full trace without the abort hint
+  printGraph(profileId);
+
   tft.fillRect(100, 90, 130, 40, BACKGROUND_COLOR);
   tft.setCursor(100, 90);
   tft.print("Reflow Done!");
@@ -464,29 +1160,53 @@ void reflowFinishedScreen()
   tft.print("Press any button to continue!");
 }
 
+// print boot splash while the remaining peripherals come up
+// the 1 bit bitmap is expanded row by row and streamed into a single address window
+void splashScreen()
+{
+  Serial.println("TRACE > splashScreen()");
+
+  const int x0 = (tft.width() - SPLASH_WIDTH) / 2;
+  const int y0 = (tft.height() - SPLASH_HEIGHT) / 2 - 20;
+  uint16_t line[SPLASH_WIDTH];
+
+  tft.startWrite();
+  tft.setAddrWindow(x0, y0, SPLASH_WIDTH, SPLASH_HEIGHT);
+  for (int row = 0; row < SPLASH_HEIGHT; row++)
+  {
+    for (int col = 0; col < SPLASH_WIDTH; col++)
+    {
+      uint8_t bits = pgm_read_byte(&SPLASH_BITMAP[row * (SPLASH_WIDTH / 8) + col / 8]);
+      line[col] = (bits & (0x80 >> (col & 7))) ? GRAPH_COLOR : BACKGROUND_COLOR;
+    }
+    tft.writePixels(line, SPLASH_WIDTH);
+  }
+  tft.endWrite();
+
+  tft.setTextSize(2);
+  tft.setTextColor(TEXT_COLOR);
+  tft.setCursor(x0 - 6, y0 + SPLASH_HEIGHT + 10);
+  tft.print("HeatPlate");
+  tft.setTextSize(1);
+}
+
 void setup(void)
 {
-  Serial.begin(115200);
+  // drive SSRs safe-off before anything else, the pins float until configured
+  HEATERS.begin();
 
-  // Configure the ButtonConfig with the event handler, and enable all higher
-  // level events.
-  ButtonConfig *buttonConfig = ButtonConfig::getSystemButtonConfig();
-  buttonConfig->setEventHandler(handleEvent);
-  // buttonConfig->setFeature(ButtonConfig::kFeatureClick);
-  // buttonConfig->setFeature(ButtonConfig::kFeatureDoubleClick);
-  // buttonConfig->setFeature(ButtonConfig::kFeatureLongPress);
-  // buttonConfig->setFeature(ButtonConfig::kFeatureRepeatPress);
+  Serial.begin(115200);
+  Serial.println("PWM Output and PID initialized");
 
-  // if (button1.isPressedRaw())
-  // {
-  //   Serial.println(F("setup(): button 1 was pressed while booting"));
-  // }
+  currentProfile = PROFILE_FAST_LEADED;
+  currentState = STATE_START;
 
-  pinMode(BUTTON_PIN1, INPUT);
-  pinMode(BUTTON_PIN2, INPUT);
-  pinMode(BUTTON_PIN3, INPUT);
-  pinMode(BUTTON_PIN4, INPUT);
+  // bring up display, sensors and buttons in parallel, each task reports back via BOOT_EVENTS
+  BOOT_EVENTS = xEventGroupCreate();
+  BUTTON_QUEUE = xQueueCreate(BUTTON_QUEUE_LENGTH, sizeof(uint8_t));
 
+  xTaskCreatePinnedToCore(DISPLAY_INIT_CODE, "Display Init", 4096, NULL, 3, &DISPLAY_INIT, 1);
+  xTaskCreatePinnedToCore(SENSOR_INIT_CODE, "Sensor Init", 4096, NULL, 3, &SENSOR_INIT, 0);
   xTaskCreatePinnedToCore(BUTTON_HANDLER_CODE, /* Task function */
                           "Display Handler",   /* Name of Task */
                           10000,               /* Stack size of Task */
@@ -495,120 +1215,436 @@ void setup(void)
                           &BUTTON_HANDLER,     /* Task Handle to keep track of created Task */
                           0);                  /* Pin Task to Core */
 
-  tft.init(240, 320); // Init ST7789 320x240
-  Serial.println("TFT Initialized");
-  tft.invertDisplay(false);
-  tft.setRotation(45);
+  // loop() draws on tft right away, so the display task must be done with it and with the glyph atlas
+  xEventGroupWaitBits(BOOT_EVENTS, BOOT_DISPLAY_READY, pdFALSE, pdTRUE, portMAX_DELAY);
+  EventBits_t ready = xEventGroupWaitBits(BOOT_EVENTS, BOOT_ALL_READY, pdFALSE, pdTRUE, pdMS_TO_TICKS(BOOT_TIMEOUT));
+  if ((ready & BOOT_ALL_READY) != BOOT_ALL_READY)
+  {
+    Serial.printf("WARN > setup(): boot timeout, ready bits: 0x%02x\n", ready);
+  }
 
-  currentProfile = PROFILE_FAST_LEADED;
-  currentState = STATE_START;
+  powerInit();
+}
 
-  Serial.println("Temperature Sensor Test");
-  Serial.println("Temperature Readings:");
-  Serial.printf("\tSensor 1: %f °C", TEMP1.readCelsius());
-  Serial.printf("\tSensor 2: %f °C", TEMP2.readCelsius());
-  Serial.printf("\tSensor 3: %f °C\n", TEMP3.readCelsius());
+bool requestedRedraw = true;
 
-  THERMO_CONTROL.SetMode(AUTOMATIC);
-  Serial.println("PID initialized");
+// update status cells round robin until the frame budget is used up
+// at least one cell is drawn per frame so every value keeps refreshing
+inline void printStatusChartValuesBudgeted(const int profileId, const int currentTime, const unsigned long frameStart)
+{
+  for (int drawn = 0; drawn < 5; drawn++)
+  {
+    if (drawn > 0 && millis() - frameStart >= FRAME_BUDGET)
+    {
+      return;
+    }
+    printStatusChartValue(nextStatusRow, profileId, currentTime);
+    nextStatusRow = (nextStatusRow + 1) % 5;
+  }
+}
 
-  ledcSetup(PWM_CHANNEL, PWM_FREQ, PWM_RES);
-  ledcAttachPin(PWM_PIN, PWM_CHANNEL);
-  Serial.println("PWM Output initialized");
+// keep live values updated on the landing screen
+void reflowLandingUpdate(const int profileId, const unsigned long frameStart)
+{
+  printStatusChartValuesBudgeted(profileId, 0, frameStart);
 }
 
-bool requestedRedraw = true;
+// reflow clock starts with the transition, loop() derives the runtime from it before the entry screen is drawn
+void reflowStarted()
+{
+  reflowStartTime = millis();
+  reflowRuntime = 0;
+}
 
-void drawScreen()
+// keep graph and live values updated while reflow process is running
+void reflowStartedUpdate(const int profileId, const unsigned long frameStart)
 {
-  if (!requestedRedraw)
+  if (reflowRuntime > getTotalTime(profileId))
   {
+    reflowRuntime = 0;
+    requestState(STATE_REFLOW_FINISHED);
     return;
   }
 
-  Serial.printf("INFO > drawScreen(): running on core %d\n", xPortGetCoreID());
+  printGraphUpdate(profileId, frameStart);
+  printStatusChartValuesBudgeted(profileId, reflowRuntime, frameStart);
+}
+
+/* State Machine Definitions start */
+#define KEEP_STATE STATE_MAX      // transition target that stays in the current state
+#define KEEP_PROFILE Profile::MAX // transition that does not change the selected profile
+
+// where a button press leads
+struct Transition
+{
+  State target;
+  Profile profile; // selected before entering target
+};
 
-  switch (currentState)
+// everything the firmware needs to know about one state
+struct StateDescriptor
+{
+  const char *name;
+  void (*entered)(); // side effects of entering, run with the transition before the screen is drawn, NULL if none
+  void (*enter)(const int profileId);                                // full screen drawn on entry
+  void (*update)(const int profileId, const unsigned long frameStart); // periodic update, NULL for static screens
+  unsigned long updatePeriod; // ms between updates while values are stable
+  unsigned long activePeriod; // ms between updates while the plate ramps or is near the profile peak
+  Transition transitions[4];  // indexed by button id
+};
+
+// rows are indexed by State and must follow its order
+constexpr StateDescriptor STATES[STATE_MAX] = {
+    // STATE_START
+    {"startScreen",
+     NULL,
+     startScreen,
+     NULL,
+     0,
+     0,
+     {{STATE_REFLOW_LANDING, KEEP_PROFILE},
+      {STATE_PROFILE_SELECTION, KEEP_PROFILE},
+      {KEEP_STATE, KEEP_PROFILE},
+      {KEEP_STATE, KEEP_PROFILE}}},
+    // STATE_PROFILE_SELECTION
+    {"profileSelectScreen",
+     NULL,
+     profileSelectScreen,
+     NULL,
+     0,
+     0,
+     {{STATE_START, PROFILE_STANDARD_UNLEADED},
+      {STATE_START, PROFILE_FAST_UNLEADED},
+      {STATE_START, PROFILE_STANDARD_LEADED},
+      {STATE_START, PROFILE_FAST_LEADED}}},
+    // STATE_REFLOW_LANDING
+    {"reflowLandingScreen",
+     NULL,
+     reflowLandingScreen,
+     reflowLandingUpdate,
+     REFRESH_PERIOD_IDLE,
+     REFRESH_PERIOD_NORMAL,
+     {{STATE_START, KEEP_PROFILE},
+      {STATE_REFLOW_STARTED, KEEP_PROFILE},
+      {KEEP_STATE, KEEP_PROFILE},
+      {KEEP_STATE, KEEP_PROFILE}}},
+    // STATE_REFLOW_STARTED
+    {"reflowStartedScreen",
+     reflowStarted,
+     reflowStartedScreen,
+     reflowStartedUpdate,
+     REFRESH_PERIOD_NORMAL,
+     REFRESH_PERIOD_FAST,
+     {{STATE_START, KEEP_PROFILE},
+      {STATE_START, KEEP_PROFILE},
+      {STATE_START, KEEP_PROFILE},
+      {STATE_START, KEEP_PROFILE}}},
+    // STATE_REFLOW_FINISHED
+    {"reflowFinishedScreen",
+     NULL,
+     reflowFinishedScreen,
+     NULL,
+     0,
+     0,
+     {{STATE_START, KEEP_PROFILE},
+      {STATE_START, KEEP_PROFILE},
+      {STATE_START, KEEP_PROFILE},
+      {STATE_START, KEEP_PROFILE}}},
+};
+/* State Machine Definitions end */
+
+// switch to another state, runs its entry hook right away and its screen with the next drawScreen()
+// STATE_MAX and the current state are no-ops, so only real entries cause a redraw
+// only called from loop(), button presses reach it through BUTTON_QUEUE
+void requestState(const State next)
+{
+  if (next == STATE_MAX || next == currentState)
   {
-  case STATE_START:
-    startScreen(currentProfile);
-    Serial.println("TRACE > drawscreen(): startScreen");
-    break;
-  case STATE_PROFILE_SELECTION:
-    profileSelectScreen();
-    Serial.println("TRACE > drawscreen(): profileSelectScreen");
-    break;
-  case STATE_REFLOW_LANDING:
-    reflowLandingScreen(currentProfile);
-    Serial.println("TRACE > drawscreen(): reflowLandingScreen");
-    break;
-  case STATE_REFLOW_STARTED:
-    reflowStartedScreen(currentProfile);
-    Serial.println("TRACE > drawscreen(): reflowStartedScreen");
-    break;
-  case STATE_REFLOW_FINISHED:
-    reflowFinishedScreen();
-    Serial.println("TRACE > drawscreen(): reflowFinishedScreen");
-    break;
-  default:
-    break;
+    return;
+  }
+
+  Serial.printf("TRACE > requestState(): %d -> %d\n", currentState, next);
+
+  if (STATES[next].entered != NULL)
+  {
+    STATES[next].entered();
+  }
+  currentState = next;
+  requestedRedraw = true;
+}
+
+// apply the transitions of all buttons pressed since the last loop() pass
+void handleButtonQueue()
+{
+  uint8_t buttonId;
+
+  while (xQueueReceive(BUTTON_QUEUE, &buttonId, 0) == pdTRUE)
+  {
+    const Transition &transition = STATES[currentState].transitions[buttonId];
+
+    if (transition.profile != KEEP_PROFILE)
+    {
+      currentProfile = transition.profile;
+      Serial.print("TRACE > handleButtonQueue(): currentProfile -> ");
+      Serial.println(currentProfile);
+    }
+
+    requestState(transition.target);
+  }
+}
+
+// pick the screen update period of the current state from the process dynamics
+// active period while the plate ramps or sits near the peak, update period otherwise
+unsigned long getRefreshPeriod(const StateDescriptor &state)
+{
+  const bool ramping = fabs(plateTempRate) > REFRESH_RAMP_RATE;
+  const bool nearPeak = plateTemp >= SOLDER_PROFILES[currentProfile][2][0] - REFRESH_PEAK_BAND;
+
+  return ramping || nearPeak ? state.activePeriod : state.updatePeriod;
+}
+
+void drawScreen()
+{
+  if (!requestedRedraw)
+  {
+    return;
   }
 
+  // cleared first, a transition requested while drawing is not lost
   requestedRedraw = false;
+
+  Serial.printf("INFO > drawScreen(): running on core %d\n", xPortGetCoreID());
+
+  const StateDescriptor &state = STATES[currentState];
+  state.enter(currentProfile);
+  Serial.printf("TRACE > drawscreen(): %s\n", state.name);
 }
 
 void drawScreenUpdate()
 {
-  State lastState = currentState;
+  const StateDescriptor &state = STATES[currentState];
+  if (state.update == NULL)
+  {
+    return;
+  }
 
-  if (millis() - lastTFTwrite > 1000)
+  refreshPeriod = getRefreshPeriod(state);
+
+  if (millis() - lastTFTwrite > refreshPeriod)
   {
     // Serial.printf("INFO > drawScreenUpdate(): running on core %d\n", xPortGetCoreID());
-    lastTFTwrite = millis();
+    const unsigned long frameStart = millis();
+    lastTFTwrite = frameStart;
+
+    state.update(currentProfile, frameStart);
 
-    switch (currentState)
+    const unsigned long frameTime = millis() - frameStart;
+    if (frameTime > FRAME_BUDGET)
     {
-    case STATE_REFLOW_LANDING:
-      printStatusChartValues(currentProfile, 0);
+      Serial.printf("WARN > drawScreenUpdate(): frame took %lu ms, budget %d ms\n", frameTime, FRAME_BUDGET);
+    }
+  }
+}
 
-      break;
-    case STATE_REFLOW_STARTED:
-      if (reflowRuntime > getTotalTime(currentProfile))
-      {
-        reflowRuntime = 0;
-        currentState = STATE_REFLOW_FINISHED;
-      }
-      else
-      {
-        printReflowGraph(currentProfile, reflowRuntime);
-        printStatusChartValues(currentProfile, reflowRuntime);
-        reflowRuntime++;
-      }
+// sensor slot: sample all thermocouples at the MAX6675 conversion rate and cache the results
+void readSensors()
+{
+  const unsigned long now = millis();
+  HEATERS.sample(now);
 
-      break;
-    default:
-      break;
+  if (now - lastSensorRead < TEMP_SAMPLE_PERIOD)
+  {
+    return;
+  }
+
+  const float lastPlateTemp = plateTemp;
+  plateTemp = HEATERS.temperature(0);
+  housingTemp = TEMP3.readCelsius();
+
+  // smoothing keeps the 0.25 °C sensor quantization from toggling the refresh rate
+  // an open thermocouple reads NAN, which would stick in the filter for good
+  if (lastSensorRead != 0 && !isnan(plateTemp) && !isnan(lastPlateTemp))
+  {
+    const float rate = (plateTemp - lastPlateTemp) * MS_TO_S / (float)(now - lastSensorRead);
+    plateTempRate = 0.8 * plateTempRate + 0.2 * rate;
+  }
+  lastSensorRead = now;
+}
+
+// enable DFS and tickless idle if the framework was built with CONFIG_PM_ENABLE
+// the stock framework = arduino build lacks CONFIG_FREERTOS_USE_TICKLESS_IDLE, there this only drops the
+// idle CPU clock to CPU_FREQ_IDLE and never light sleeps, see README
+// buttons and touch interrupt are light sleep wake sources, all of them are active low
+void powerInit()
+{
+  for (int i = 0; i < 4; i++)
+  {
+    gpio_wakeup_enable((gpio_num_t)BUTTON_PINS[i], GPIO_INTR_LOW_LEVEL);
+  }
+  gpio_wakeup_enable((gpio_num_t)TOUCH_INTERRUPT, GPIO_INTR_LOW_LEVEL);
+  esp_sleep_enable_gpio_wakeup();
+
+#if CONFIG_PM_ENABLE
+  esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "reflow", &REFLOW_FREQ_LOCK);
+  esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "reflow", &REFLOW_SLEEP_LOCK);
+
+  esp_pm_config_esp32_t pmConfig = {};
+  pmConfig.max_freq_mhz = CPU_FREQ_MAX;
+  pmConfig.min_freq_mhz = CPU_FREQ_IDLE;
+  pmConfig.light_sleep_enable = true;
+
+  esp_err_t err = esp_pm_configure(&pmConfig);
+  if (err == ESP_ERR_NOT_SUPPORTED)
+  {
+    // framework built without tickless idle, keep frequency scaling only
+    pmConfig.light_sleep_enable = false;
+    err = esp_pm_configure(&pmConfig);
+  }
+  else
+  {
+    lightSleepEnabled = err == ESP_OK;
+  }
+  pmEnabled = err == ESP_OK;
+#endif
+
+  Serial.printf("INFO > powerInit(): DFS %s, light sleep %s\n", pmEnabled ? "esp_pm" : "manual",
+                lightSleepEnabled ? "on" : "off");
+
+  setPowerMode(false);
+}
+
+// hold CPU at max frequency and block light sleep only while a reflow is running
+void setPowerMode(const bool reflowRunning)
+{
+  if (reflowRunning == performanceMode)
+  {
+    return;
+  }
+  performanceMode = reflowRunning;
+
+#if CONFIG_PM_ENABLE
+  if (pmEnabled)
+  {
+    if (reflowRunning && !pmLocksHeld)
+    {
+      esp_pm_lock_acquire(REFLOW_FREQ_LOCK);
+      esp_pm_lock_acquire(REFLOW_SLEEP_LOCK);
+      pmLocksHeld = true;
     }
+    else if (!reflowRunning && pmLocksHeld)
+    {
+      esp_pm_lock_release(REFLOW_SLEEP_LOCK);
+      esp_pm_lock_release(REFLOW_FREQ_LOCK);
+      pmLocksHeld = false;
+    }
+  }
+  else
+#endif
+  {
+    setCpuFrequencyMhz(reflowRunning ? CPU_FREQ_MAX : CPU_FREQ_IDLE);
+  }
+
+  // start a fresh measurement window for the idle report
+  loopActiveTime = 0;
+  buttonActiveTime = 0;
+  lastPowerReport = millis();
+
+  Serial.printf("INFO > setPowerMode(): %s\n", reflowRunning ? "performance" : "idle");
+}
+
+// report the measured share of time spent working while idle, together with an MCU current estimate
+// derived from it and the *_ESTIMATE datasheet figures, nothing here measures current
+// both cores are summed, so the share is an upper bound of the time light sleep was blocked
+void reportPower()
+{
+  const unsigned long window = millis() - lastPowerReport;
+  if (window < POWER_REPORT_PERIOD)
+  {
+    return;
+  }
+
+  float activeShare = (loopActiveTime + buttonActiveTime) / (window * 1000.0);
+  if (activeShare > 1)
+  {
+    activeShare = 1;
   }
+  const float waitCurrent = lightSleepEnabled ? CURRENT_LIGHT_SLEEP_ESTIMATE : CURRENT_NO_SLEEP_ESTIMATE;
+  const float current = activeShare * CURRENT_ACTIVE_ESTIMATE + (1 - activeShare) * waitCurrent;
 
-  if (lastState != currentState)
+  Serial.printf("INFO > reportPower(): %lu MHz, light sleep %s, measured active %.1f %%, "
+                "datasheet estimate %.1f mA (not measured)\n",
+                (unsigned long)getCpuFrequencyMhz(), lightSleepEnabled ? "on" : "off", activeShare * 100, current);
+
+  loopActiveTime = 0;
+  buttonActiveTime = 0;
+  lastPowerReport = millis();
+}
+
+void DISPLAY_INIT_CODE(void *pvParameters)
+{
+  tft.init(240, 320); // Init ST7789 320x240
+  tft.setSPISpeed(TFT_SPI_FREQ);
+  tft.invertDisplay(false);
+  tft.setRotation(45);
+  tft.fillScreen(BACKGROUND_COLOR);
+  splashScreen();
+  buildGlyphAtlas();
+  Serial.println("TFT Initialized");
+
+  xEventGroupSetBits(BOOT_EVENTS, BOOT_DISPLAY_READY);
+  vTaskDelete(NULL);
+}
+
+void SENSOR_INIT_CODE(void *pvParameters)
+{
+  // first conversion is only valid once the MAX6675 had time to sample after power up
+  if (millis() < TEMP_CONVERSION_TIME)
   {
-    requestedRedraw = true;
+    vTaskDelay(pdMS_TO_TICKS(TEMP_CONVERSION_TIME - millis()));
   }
+
+  Serial.println("Temperature Sensor Test");
+  Serial.println("Temperature Readings:");
+  Serial.printf("\tSensor 1: %f °C", TEMP1.readCelsius());
+  Serial.printf("\tSensor 2: %f °C", TEMP2.readCelsius());
+  Serial.printf("\tSensor 3: %f °C\n", TEMP3.readCelsius());
+
+  xEventGroupSetBits(BOOT_EVENTS, BOOT_SENSORS_READY);
+  vTaskDelete(NULL);
 }
 
 void BUTTON_HANDLER_CODE(void *pvParameters)
 {
+  // Configure the ButtonConfig with the event handler, and enable all higher
+  // level events.
+  ButtonConfig *buttonConfig = ButtonConfig::getSystemButtonConfig();
+  buttonConfig->setEventHandler(handleEvent);
+  // buttonConfig->setFeature(ButtonConfig::kFeatureClick);
+  // buttonConfig->setFeature(ButtonConfig::kFeatureDoubleClick);
+  // buttonConfig->setFeature(ButtonConfig::kFeatureLongPress);
+  // buttonConfig->setFeature(ButtonConfig::kFeatureRepeatPress);
+
+  pinMode(BUTTON_PIN1, INPUT);
+  pinMode(BUTTON_PIN2, INPUT);
+  pinMode(BUTTON_PIN3, INPUT);
+  pinMode(BUTTON_PIN4, INPUT);
+
+  xEventGroupSetBits(BOOT_EVENTS, BOOT_INPUT_READY);
+  // do not act on presses before the screens can be drawn
+  xEventGroupWaitBits(BOOT_EVENTS, BOOT_DISPLAY_READY, pdFALSE, pdTRUE, portMAX_DELAY);
+
   for (;;)
   {
     unsigned long start0 = millis();
+    const unsigned long activeStart0 = micros();
     // drawScreen();
     // drawScreenUpdate();
     button1.check();
     button2.check();
     button3.check();
     button4.check();
-    vTaskDelay(10);
+    buttonActiveTime += micros() - activeStart0;
+    vTaskDelay(pdMS_TO_TICKS(performanceMode ? BUTTON_POLL_ACTIVE : BUTTON_POLL_IDLE));
     yield();
 
     /*
@@ -664,36 +1700,45 @@ int getSetPoint(const int profileId, const int runtime)
 
 void loop()
 {
-  unsigned long start = millis();
+  const unsigned long activeStart = micros();
+
+  handleButtonQueue();
+  setPowerMode(currentState == STATE_REFLOW_STARTED);
+
+  // sensor and control slots run first, rendering only gets what is left
+  readSensors();
+
+  if (currentState == STATE_REFLOW_STARTED)
+  {
+    reflowRuntime = (millis() - reflowStartTime) / MS_TO_S;
+  }
+
+  const bool heating = currentState == STATE_REFLOW_STARTED && reflowRuntime < getTotalTime(currentProfile);
+  HEATERS.setSetpoint(heating ? getSetPoint(currentProfile, reflowRuntime) : 0);
+  HEATERS.control(millis(), heating);
+  HEATERS.drive(millis());
+
+  if (heating)
+  {
+    graphSample(currentProfile, millis() - reflowStartTime);
+  }
 
   drawScreen();
   drawScreenUpdate();
 
-  unsigned long duration = millis() - start;
-  if ((millis() - lastSerialPrint1) > 1000)
+  if (!bootTimeLogged)
   {
-    lastSerialPrint1 = millis();
-    // Serial.printf("INFO > loop(): running on core %d\n", xPortGetCoreID());
-    // Serial.printf("INFO > loop(): took %d ms\n", duration);
-    if (currentState == STATE_REFLOW_STARTED && reflowRuntime < getTotalTime(currentProfile))
-    {
-      float temp = (TEMP1.readCelsius() + TEMP2.readCelsius()) / 2;
-      Input = double(temp);
-      Setpoint = double(getSetPoint(currentProfile, reflowRuntime));
-      THERMO_CONTROL.Compute();
+    bootTimeLogged = true;
+    Serial.printf("INFO > loop(): boot to interactive took %lu ms\n", millis());
+  }
 
-      ledcWrite(PWM_CHANNEL, Output);
+  loopActiveTime += micros() - activeStart;
 
-      Serial.println("TRACE > loop(): PID calculation started");
-      Serial.printf("\tInput: %f", Input);
-      Serial.printf("\tSetpoint: %f", Setpoint);
-      Serial.printf("\tOutput: %f\n", Output);
-    }
-    else
-    {
-      ledcWrite(PWM_CHANNEL, 0);
-      Serial.println("INFO > loop(): PWM off");
-    }
+  // let the idle task run so DFS and light sleep can kick in
+  if (!performanceMode)
+  {
+    reportPower();
+    delay(LOOP_IDLE_DELAY);
   }
 }
 
@@ -712,93 +1757,15 @@ void handleEvent(AceButton *button, uint8_t eventType, uint8_t buttonState)
   Serial.print(F("; currentProfile: "));
   Serial.println(currentProfile);
 
-  const int tmax = getTotalTime(currentProfile);
-
-  State lastState = currentState;
-
-  switch (currentState)
+  if (eventType != AceButton::kEventPressed)
   {
-  case STATE_START:
-    switch (eventType)
-    {
-    case AceButton::kEventPressed:
-      switch (button->getPin())
-      {
-        // press button 1 to start reflow process
-      case BUTTON_PIN1:
-        currentState = STATE_REFLOW_LANDING;
-        break;
-        // press button 2 to select desired reflow profile
-      case BUTTON_PIN2:
-        currentState = STATE_PROFILE_SELECTION;
-        break;
-      }
-    }
-
-    break;
-  case STATE_PROFILE_SELECTION:
-    // selects reflow profile according to pressed button
-    switch (eventType)
-    {
-    case AceButton::kEventPressed:
-      switch (button->getPin())
-      {
-      case BUTTON_PIN1:
-        currentProfile = PROFILE_STANDARD_UNLEADED;
-        break;
-      case BUTTON_PIN2:
-        currentProfile = PROFILE_FAST_UNLEADED;
-        break;
-      case BUTTON_PIN3:
-        currentProfile = PROFILE_STANDARD_LEADED;
-        break;
-      case BUTTON_PIN4:
-        currentProfile = PROFILE_FAST_LEADED;
-        break;
-      }
-
-      Serial.print("TRACE > handleEvent(): currentProfile -> ");
-      Serial.println(currentProfile);
-      currentState = STATE_START;
-    }
-
-    break;
-  case STATE_REFLOW_LANDING:
-    switch (eventType)
-    {
-    case AceButton::kEventPressed:
-      switch (button->getPin())
-      {
-      case BUTTON_PIN1:
-        currentState = STATE_START;
-        break;
-      case BUTTON_PIN2:
-        currentState = STATE_REFLOW_STARTED;
-        break;
-      }
-    }
-
-    break;
-  case STATE_REFLOW_STARTED:
-    switch (eventType)
-    {
-    case AceButton::kEventPressed:
-      currentState = STATE_START;
-      break;
-    }
-
-    break;
-  case STATE_REFLOW_FINISHED:
-    switch (eventType)
-    {
-    case AceButton::kEventPressed:
-      currentState = STATE_START;
-      break;
-    }
+    return;
   }
 
-  if (lastState != currentState)
+  // the transition is looked up and applied by loop()
+  const uint8_t buttonId = button->getId();
+  if (xQueueSend(BUTTON_QUEUE, &buttonId, 0) != pdTRUE)
   {
-    requestedRedraw = true;
+    Serial.println("WARN > handleEvent(): button queue full, press dropped");
   }
 }
\ No newline at end of file